@@ -1,8 +1,10 @@
 #include <iostream>
 #include <fstream>
 #include <string_view>
+#include <algorithm>
 
 #include "Chip8.hpp"
+#include "Debugger.hpp"
 #include "SDL2/SDL_mixer.h"
 
 Chip8::Chip8() : m_PC {START_ADDRESS}
@@ -19,6 +21,8 @@ Chip8::Chip8() : m_PC {START_ADDRESS}
 		std::cout << "Sound could not be loaded" << std::endl;
 	}
 	Mix_VolumeChunk(m_chunk.get(), MIX_MAX_VOLUME / 2);
+
+	m_hash = computeHash();
 }
 
 // Load game to memory (from 0x200)
@@ -41,24 +45,39 @@ void Chip8::loadGame(std::string_view path) {
 		}
 
 		delete[] buffer;
+
+		m_hash = computeHash();
+		m_dirtyPages = 0xFFFF;
 	}
 }
 
+void Chip8::enableTrace(std::string_view dumpPath, size_t capacity) {
+	m_trace = std::make_unique<Trace>(dumpPath, capacity);
+}
+
 void Chip8::emulateCycle() {
+	const uint16_t pc = m_PC;
+	m_lastFault = Fault::NONE;
+
 	// Fetch Opcode
-	m_opcode = (m_memory[m_PC] << 8) | m_memory[m_PC + 1];
+	if(inMemory(pc, 2)) {
+		m_opcode = (m_memory[pc] << 8) | m_memory[pc + 1];
+		setPC(m_PC + 2);
+
+		// Decode and execute Opcode
+		fromOpcodeToFunction();
 
-	m_PC += 2;
+		if(m_trace) m_trace->record(pc, m_opcode, m_RI, m_registers[(m_opcode & 0x0F00) >> 8], m_SP);
+	}
 
-	// Decode and execute Opcode
-	fromOpcodeToFunction();
+	if(m_lastFault != Fault::NONE) reportFault(pc);
 
 	// Update timers
-	if(m_delayTimer > 0) m_delayTimer--;
+	if(m_delayTimer > 0) setDelayTimer(m_delayTimer - 1);
 
 	if(m_soundTimer > 0) {
 		if (m_soundTimer == 1) Mix_PlayChannel(-1, m_chunk.get(), 0);
-		m_soundTimer--;
+		setSoundTimer(m_soundTimer - 1);
 	}
 
 }
@@ -123,29 +142,38 @@ void Chip8::fromOpcodeToFunction() {
 
 // Clear the display
 void Chip8::OPCODE_00E0() {
-	m_graphics.fill(0);
+	for(uint16_t pixel = 0; pixel < m_graphics.size(); ++pixel){
+		if(m_graphics[pixel]) flipPixel(pixel);
+	}
 }
 
 //  The interpreter sets the program counter to the address at the top of the stack,
 //  then subtracts 1 from the stack pointer.
 void Chip8::OPCODE_00EE() {
-	m_SP--;
-	m_PC = m_stack[m_SP];
+	if(m_SP == 0) {
+		raiseFault(Fault::STACK_UNDERFLOW);
+		return;
+	}
+	popStack();
+	setPC(m_stack[m_SP]);
 }
 
 // Jump to location nnn.
 void Chip8::OPCODE_1nnn() {
 	uint16_t nnn = m_opcode & 0x0FFF;
-	m_PC = nnn;
+	setPC(nnn);
 }
 
 //  The interpreter increments the stack pointer, then puts the current PC on the top of the stack.
 //  The PC is then set to nnn.
 void Chip8::OPCODE_2nnn() {
 	uint16_t nnn = m_opcode & 0x0FFF;
-	m_stack[m_SP] = m_PC;
-	m_SP++;
-	m_PC = nnn;
+	if(m_SP >= STACK_DEPTH) {
+		raiseFault(Fault::STACK_OVERFLOW);
+		return;
+	}
+	pushStack(m_PC);
+	setPC(nnn);
 }
 
 //  The interpreter compares register Vx to kk, and if they are equal,
@@ -153,7 +181,7 @@ void Chip8::OPCODE_2nnn() {
 void Chip8::OPCODE_3xkk() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t kk = m_opcode & 0x00FF;
-	if(m_registers[Vx] == kk) m_PC += 2;
+	if(m_registers[Vx] == kk) setPC(m_PC + 2);
 
 }
 
@@ -162,7 +190,7 @@ void Chip8::OPCODE_3xkk() {
 void Chip8::OPCODE_4xkk() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t kk = m_opcode & 0x00FF;
-	if(m_registers[Vx] != kk) m_PC += 2;
+	if(m_registers[Vx] != kk) setPC(m_PC + 2);
 }
 
 //  The interpreter compares register Vx to register Vy, and if they are equal,
@@ -170,49 +198,49 @@ void Chip8::OPCODE_4xkk() {
 void Chip8::OPCODE_5xy0() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
-	if(m_registers[Vx] == m_registers[Vy]) m_PC += 2;
+	if(m_registers[Vx] == m_registers[Vy]) setPC(m_PC + 2);
 }
 
 // The interpreter puts the value kk into register Vx.
 void Chip8::OPCODE_6xkk() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t kk = m_opcode & 0x00FF;
-	m_registers[Vx] = kk;
+	setRegister(Vx, kk);
 }
 
 //  Adds the value kk to the value of register Vx, then stores the result in Vx.
 void Chip8::OPCODE_7xkk() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t kk = m_opcode & 0x00FF;
-	m_registers[Vx] = m_registers[Vx] + kk;
+	setRegister(Vx, m_registers[Vx] + kk);
 }
 
 // Stores the value of register Vy in register Vx.
 void Chip8::OPCODE_8xy0() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
-	m_registers[Vx] = m_registers[Vy];
+	setRegister(Vx, m_registers[Vy]);
 }
 
 // Performs a bitwise OR on the values of Vx and Vy, then stores the result in Vx.
 void Chip8::OPCODE_8xy1() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
-	m_registers[Vx] = m_registers[Vx] | m_registers[Vy];
+	setRegister(Vx, m_registers[Vx] | m_registers[Vy]);
 }
 
 // Performs a bitwise AND on the values of Vx and Vy, then stores the result in Vx.
 void Chip8::OPCODE_8xy2() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
-	m_registers[Vx] = m_registers[Vx] & m_registers[Vy];
+	setRegister(Vx, m_registers[Vx] & m_registers[Vy]);
 }
 
 // Performs a bitwise exclusive OR on the values of Vx and Vy, then stores the result in Vx.
 void Chip8::OPCODE_8xy3() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
-	m_registers[Vx] = m_registers[Vx] ^ m_registers[Vy];
+	setRegister(Vx, m_registers[Vx] ^ m_registers[Vy]);
 }
 
 // Set Vx = Vx + Vy, set VF = carry.
@@ -222,8 +250,8 @@ void Chip8::OPCODE_8xy4() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
 	uint16_t sum = m_registers[Vx] + m_registers[Vy];
-	m_registers[0xF] = (sum > 255 ? 1 : 0);
-	m_registers[Vx] = sum & 0xFF;
+	setRegister(0xF, (sum > 255 ? 1 : 0));
+	setRegister(Vx, sum & 0xFF);
 }
 
 // Set Vx = Vx - Vy, set VF = NOT borrow.
@@ -233,16 +261,16 @@ void Chip8::OPCODE_8xy5() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
 	uint16_t sub = m_registers[Vx] - m_registers[Vy];
-	m_registers[0xF] = (m_registers[Vx] > m_registers[Vy] ? 1 : 0);
-	m_registers[Vx] = sub;
+	setRegister(0xF, (m_registers[Vx] > m_registers[Vy] ? 1 : 0));
+	setRegister(Vx, sub);
 }
 
 // Set Vx = Vx SHR 1.
 // If the least-significant bit of Vx is 1, then VF is set to 1, otherwise 0. Then Vx is divided by 2.
 void Chip8::OPCODE_8xy6() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
-	m_registers[0xF] = (m_registers[Vx] & 0x1);
-	m_registers[Vx] = m_registers[Vx] >> 1;
+	setRegister(0xF, (m_registers[Vx] & 0x1));
+	setRegister(Vx, m_registers[Vx] >> 1);
 }
 
 // Set Vx = Vy - Vx, set VF = NOT borrow.
@@ -251,8 +279,8 @@ void Chip8::OPCODE_8xy6() {
 void Chip8::OPCODE_8xy7() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
-	m_registers[0xF] = (m_registers[Vy] > m_registers[Vx] ? 1 : 0);
-	m_registers[Vx] = m_registers[Vy] - m_registers[Vx];
+	setRegister(0xF, (m_registers[Vy] > m_registers[Vx] ? 1 : 0));
+	setRegister(Vx, m_registers[Vy] - m_registers[Vx]);
 }
 
 // Set Vx = Vx SHL 1.
@@ -260,8 +288,8 @@ void Chip8::OPCODE_8xy7() {
 // Then Vx is multiplied by 2.
 void Chip8::OPCODE_8xyE() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
-	m_registers[0xF] = (m_registers[Vx] & 0x80) >> 7;
-	m_registers[Vx] = m_registers[Vx] << 1;
+	setRegister(0xF, (m_registers[Vx] & 0x80) >> 7);
+	setRegister(Vx, m_registers[Vx] << 1);
 }
 
 // Skip next instruction if Vx != Vy.
@@ -270,20 +298,20 @@ void Chip8::OPCODE_8xyE() {
 void Chip8::OPCODE_9xy0() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t Vy = (m_opcode & 0x00F0) >> 4;
-	if(m_registers[Vx] != m_registers[Vy]) m_PC += 2;
+	if(m_registers[Vx] != m_registers[Vy]) setPC(m_PC + 2);
 }
 
 // The value of register I is set to nnn.
 void Chip8::OPCODE_Annn() {
 	uint16_t nnn = m_opcode & 0x0FFF;
-	m_RI = nnn;
+	setIndex(nnn);
 }
 
 // Jump to location nnn + V0.
 // The program counter is set to nnn plus the value of V0.
 void Chip8::OPCODE_Bnnn() {
 	uint16_t nnn = m_opcode & 0x0FFF;
-	m_PC = nnn + m_registers[0];
+	setPC(nnn + m_registers[0]);
 }
 
 // Set Vx = random byte AND kk.
@@ -293,7 +321,7 @@ void Chip8::OPCODE_Cxkk() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t kk = m_opcode & 0x00FF;
 	uint8_t random = dist(mt);
-	m_registers[Vx] = (random & kk);
+	setRegister(Vx, (random & kk));
 }
 
 // Display n-byte sprite starting at memory location I at (Vx, Vy), set VF = collision.
@@ -311,16 +339,19 @@ void Chip8::OPCODE_Dxyn() {
 	uint8_t xPos = m_registers[Vx] % DISPLAY_WIDTH;
 	uint8_t yPos = m_registers[Vy] % DISPLAY_HEIGHT;
 
-	m_registers[0xF] = 0;
+	if(!inMemory(m_RI, n)) return;
+	if(m_watcher) m_watcher->onAccess(m_RI, n, Access::READ);
+
+	setRegister(0xF, 0);
 
 	for(uint row {}; row < n; ++row){
 		uint8_t spriteByte = m_memory[m_RI + row];
 		for(uint col {}; col < 8; ++col){
 			uint8_t spritePixel = spriteByte & (0x80 >> col);
-			uint32_t& screenPixel = m_graphics[(yPos + row) * DISPLAY_WIDTH + (xPos + col)];
+			uint16_t pixel = ((yPos + row) % DISPLAY_HEIGHT) * DISPLAY_WIDTH + (xPos + col) % DISPLAY_WIDTH;
 			if(spritePixel) {
-				if (screenPixel == 0xFFFFFFFF) m_registers[0xF] = 1;
-				screenPixel = screenPixel ^ 0xFFFFFFFF;
+				if (m_graphics[pixel] == 0xFFFFFFFF) setRegister(0xF, 1);
+				flipPixel(pixel);
 			}
 		}
 	}
@@ -332,20 +363,28 @@ void Chip8::OPCODE_Dxyn() {
 void Chip8::OPCODE_Ex9E() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t key = m_registers[Vx];
-	if(m_keypad[key]) m_PC += 2;
+	if(key >= CHAR) {
+		raiseFault(Fault::MEMORY_OUT_OF_RANGE);
+		return;
+	}
+	if(m_keypad[key]) setPC(m_PC + 2);
 }
 
 // Skip next instruction if key with the value of Vx is not pressed.
 void Chip8::OPCODE_ExA1() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t key = m_registers[Vx];
-	if(!m_keypad[key]) m_PC += 2;
+	if(key >= CHAR) {
+		raiseFault(Fault::MEMORY_OUT_OF_RANGE);
+		return;
+	}
+	if(!m_keypad[key]) setPC(m_PC + 2);
 }
 
 // Set Vx = delay timer value.
 void Chip8::OPCODE_Fx07() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
-	m_registers[Vx] = m_delayTimer;
+	setRegister(Vx, m_delayTimer);
 }
 
 // Wait for a key press, store the value of the key in Vx.
@@ -355,32 +394,32 @@ void Chip8::OPCODE_Fx0A() {
 	bool keyPressed {false};
 	for(size_t i = 0; i < m_keypad.size(); ++i){
 		if(m_keypad[i]){
-			m_registers[Vx] = i;
+			setRegister(Vx, i);
 			keyPressed = true;
 			break;
 		}
 	}
 	if(!keyPressed) {
-		m_PC -= 2;
+		setPC(m_PC - 2);
 	}
 }
 
 // Set delay timer = Vx
 void Chip8::OPCODE_Fx15() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
-	m_delayTimer = m_registers[Vx];
+	setDelayTimer(m_registers[Vx]);
 }
 
 // Set sound timer = Vx.
 void Chip8::OPCODE_Fx18() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
-	m_soundTimer = m_registers[Vx];
+	setSoundTimer(m_registers[Vx]);
 }
 
 // Set I = I + Vx.
 void Chip8::OPCODE_Fx1E() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
-	m_RI = m_RI + m_registers[Vx];
+	setIndex(m_RI + m_registers[Vx]);
 }
 
 // Set I = location of sprite for digit Vx.
@@ -389,7 +428,7 @@ void Chip8::OPCODE_Fx1E() {
 void Chip8::OPCODE_Fx29() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t digit = m_registers[Vx];
-	m_RI = FONTSET_START_ADDRESS + (5 * digit);
+	setIndex(FONTSET_START_ADDRESS + (5 * digit));
 }
 
 // Store BCD representation of Vx in memory locations I, I+1, and I+2.
@@ -399,8 +438,10 @@ void Chip8::OPCODE_Fx29() {
 void Chip8::OPCODE_Fx33() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
 	uint8_t value = m_registers[Vx];
+	if(!inMemory(m_RI, 3)) return;
+	if(m_watcher) m_watcher->onAccess(m_RI, 3, Access::WRITE);
 	for(int i = 2; i >= 0; --i){
-		m_memory[m_RI+i] = value % 10;
+		writeMemory(m_RI+i, value % 10);
 		value /= 10;
 	}
 }
@@ -410,8 +451,10 @@ void Chip8::OPCODE_Fx33() {
 // starting at the address in I.
 void Chip8::OPCODE_Fx55() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
+	if(!inMemory(m_RI, Vx + 1)) return;
+	if(m_watcher) m_watcher->onAccess(m_RI, Vx + 1, Access::WRITE);
 	for(uint8_t i = 0; i <= Vx; ++i){
-		m_memory[m_RI + i] = m_registers[i];
+		writeMemory(m_RI + i, m_registers[i]);
 	}
 }
 
@@ -420,13 +463,160 @@ void Chip8::OPCODE_Fx55() {
 // into registers V0 through Vx.
 void Chip8::OPCODE_Fx65() {
 	uint8_t Vx = (m_opcode & 0x0F00) >> 8;
+	if(!inMemory(m_RI, Vx + 1)) return;
+	if(m_watcher) m_watcher->onAccess(m_RI, Vx + 1, Access::READ);
 	for(uint8_t i = 0; i <= Vx; ++i){
-		m_registers[i] = m_memory[m_RI + i];
+		setRegister(i, m_memory[m_RI + i]);
 	}
 }
 
-// Invalid OPCODE it does nothing
-void Chip8::OPCODE_INVALID() {}
+// Invalid OPCODE it does nothing apart from raising a fault
+void Chip8::OPCODE_INVALID() {
+	raiseFault(Fault::INVALID_OPCODE);
+}
+
+// Faults are reported once the instruction has been recorded, so the trace ends with the culprit
+void Chip8::raiseFault(Fault fault) {
+	m_lastFault = fault;
+}
+
+// Only the first fault is reported: a ROM stuck on an invalid opcode would otherwise rewrite the dump every cycle
+void Chip8::reportFault(uint16_t pc) {
+	const Fault fault = m_lastFault;
+	if(m_fault != Fault::NONE) return;
+	m_fault = fault;
+
+	std::cerr << "Fault: " << faultName(fault) << " at PC 0x" << std::hex << pc << std::dec << std::endl;
+	if(m_trace && !m_trace->dump(fault)) {
+		std::cerr << "Trace could not be written" << std::endl;
+	}
+}
+
+// Check that [address, address + size) lies in memory, raise a fault otherwise
+bool Chip8::inMemory(uint16_t address, uint16_t size) {
+	if(address + size <= MEMORY_SIZE) return true;
+	raiseFault(Fault::MEMORY_OUT_OF_RANGE);
+	return false;
+}
+
+void Chip8::setRegister(uint8_t reg, uint8_t value) {
+	m_hash = rehashSlot(m_hash, HashComponent::REGISTER, reg, m_registers[reg], value);
+	m_registers[reg] = value;
+}
+
+void Chip8::writeMemory(uint16_t address, uint8_t value) {
+	m_hash = rehashSlot(m_hash, HashComponent::MEMORY, address, m_memory[address], value);
+	m_memory[address] = value;
+	m_dirtyPages |= 1 << (address / MEMORY_PAGE_SIZE);
+}
+
+void Chip8::setPC(uint16_t address) {
+	m_hash = rehashSlot(m_hash, HashComponent::PC, 0, m_PC, address);
+	m_PC = address;
+}
+
+void Chip8::setIndex(uint16_t address) {
+	m_hash = rehashSlot(m_hash, HashComponent::INDEX, 0, m_RI, address);
+	m_RI = address;
+}
+
+// Only the live slots [0, m_SP) are hashed: what a RET leaves behind must not tell two states apart
+void Chip8::pushStack(uint16_t address) {
+	m_hash ^= zobrist(HashComponent::STACK, m_SP, address);
+	m_stack[m_SP] = address;
+	m_hash = rehashSlot(m_hash, HashComponent::SP, 0, m_SP, m_SP + 1);
+	m_SP++;
+}
+
+void Chip8::popStack() {
+	m_hash = rehashSlot(m_hash, HashComponent::SP, 0, m_SP, m_SP - 1);
+	m_SP--;
+	m_hash ^= zobrist(HashComponent::STACK, m_SP, m_stack[m_SP]);
+}
+
+void Chip8::setDelayTimer(uint8_t value) {
+	m_hash = rehashSlot(m_hash, HashComponent::DELAY_TIMER, 0, m_delayTimer, value);
+	m_delayTimer = value;
+}
+
+void Chip8::setSoundTimer(uint8_t value) {
+	m_hash = rehashSlot(m_hash, HashComponent::SOUND_TIMER, 0, m_soundTimer, value);
+	m_soundTimer = value;
+}
+
+// Pixels are either 0 or 0xFFFFFFFF, only lit pixels contribute to the hash
+void Chip8::flipPixel(uint16_t pixel) {
+	m_hash ^= zobrist(HashComponent::PIXEL, pixel, 1);
+	m_graphics[pixel] ^= 0xFFFFFFFF;
+	m_dirtyRows |= 1u << (pixel / DISPLAY_WIDTH);
+}
+
+uint64_t Chip8::getHash() const {
+	return m_hash;
+}
+
+uint64_t Chip8::computeHash() const {
+	uint64_t hash {};
+	for(uint16_t i = 0; i < MEMORY_SIZE; ++i) hash ^= zobrist(HashComponent::MEMORY, i, m_memory[i]);
+	for(uint8_t i = 0; i < REGISTERS; ++i) hash ^= zobrist(HashComponent::REGISTER, i, m_registers[i]);
+	for(uint8_t i = 0; i < m_SP; ++i) hash ^= zobrist(HashComponent::STACK, i, m_stack[i]);
+	for(uint16_t i = 0; i < m_graphics.size(); ++i){
+		if(m_graphics[i]) hash ^= zobrist(HashComponent::PIXEL, i, 1);
+	}
+	hash ^= zobrist(HashComponent::PC, 0, m_PC);
+	hash ^= zobrist(HashComponent::INDEX, 0, m_RI);
+	hash ^= zobrist(HashComponent::SP, 0, m_SP);
+	hash ^= zobrist(HashComponent::DELAY_TIMER, 0, m_delayTimer);
+	hash ^= zobrist(HashComponent::SOUND_TIMER, 0, m_soundTimer);
+	return hash;
+}
+
+// Dirty pages are copied into new shared pages, clean ones are still identical to the shared copy
+Chip8State Chip8::saveState() {
+	for(uint8_t page = 0; page < MEMORY_PAGES; ++page){
+		if(!(m_dirtyPages & (1 << page))) continue;
+		auto copy = std::make_shared<MemoryPage>();
+		std::copy_n(m_memory.begin() + page * MEMORY_PAGE_SIZE, MEMORY_PAGE_SIZE, copy->begin());
+		m_memoryPages[page] = std::move(copy);
+	}
+	for(uint8_t row = 0; row < DISPLAY_HEIGHT; ++row){
+		if(!(m_dirtyRows & (1u << row))) continue;
+		auto copy = std::make_shared<DisplayRow>();
+		std::copy_n(m_graphics.begin() + row * DISPLAY_WIDTH, DISPLAY_WIDTH, copy->begin());
+		m_graphicsRows[row] = std::move(copy);
+	}
+	m_dirtyPages = 0;
+	m_dirtyRows = 0;
+
+	return {m_memoryPages, m_graphicsRows, m_registers, m_RI, m_PC, m_stack, m_SP, m_delayTimer, m_soundTimer, m_fault, m_hash};
+}
+
+// Only pages that differ from the ones currently shared (or were written since) are copied back
+void Chip8::loadState(const Chip8State& state) {
+	for(uint8_t page = 0; page < MEMORY_PAGES; ++page){
+		if(m_memoryPages[page] == state.memory[page] && !(m_dirtyPages & (1 << page))) continue;
+		std::copy(state.memory[page]->begin(), state.memory[page]->end(), m_memory.begin() + page * MEMORY_PAGE_SIZE);
+		m_memoryPages[page] = state.memory[page];
+	}
+	for(uint8_t row = 0; row < DISPLAY_HEIGHT; ++row){
+		if(m_graphicsRows[row] == state.graphics[row] && !(m_dirtyRows & (1u << row))) continue;
+		std::copy(state.graphics[row]->begin(), state.graphics[row]->end(), m_graphics.begin() + row * DISPLAY_WIDTH);
+		m_graphicsRows[row] = state.graphics[row];
+	}
+	m_dirtyPages = 0;
+	m_dirtyRows = 0;
+
+	m_registers = state.registers;
+	m_RI = state.RI;
+	m_PC = state.PC;
+	m_stack = state.stack;
+	m_SP = state.SP;
+	m_delayTimer = state.delayTimer;
+	m_soundTimer = state.soundTimer;
+	m_fault = state.fault;
+	m_lastFault = Fault::NONE;
+	m_hash = state.hash;
+}
 
 const std::array<uint32_t, DISPLAY_WIDTH * DISPLAY_HEIGHT>& Chip8::getGraphics() const {
 	return m_graphics;
@@ -434,4 +624,12 @@ const std::array<uint32_t, DISPLAY_WIDTH * DISPLAY_HEIGHT>& Chip8::getGraphics()
 
 const std::array<uint8_t, CHAR>& Chip8::getKeypad() const {
 	return m_keypad;
+}
+
+Fault Chip8::getFault() const {
+	return m_fault;
+}
+
+Fault Chip8::getLastFault() const {
+	return m_lastFault;
 }
\ No newline at end of file
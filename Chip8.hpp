@@ -6,6 +6,8 @@
 #include <random>
 
 #include "SDL2/SDL_mixer.h"
+#include "StateHash.hpp"
+#include "Trace.hpp"
 
 constexpr uint16_t START_ADDRESS {0x200};
 constexpr uint16_t FONTSET_START_ADDRESS {0x50};
@@ -17,6 +19,8 @@ constexpr uint8_t DISPLAY_HEIGHT {32};
 constexpr uint16_t MEMORY_SIZE {4096};
 constexpr uint8_t REGISTERS {16};
 constexpr uint8_t STACK_DEPTH {16};
+constexpr uint16_t MEMORY_PAGE_SIZE {256};
+constexpr uint8_t MEMORY_PAGES {MEMORY_SIZE / MEMORY_PAGE_SIZE};
 constexpr std::array<uint8_t, FONT_ELEMENT_SIZE> FONTSET {
 	0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
 	0x20, 0x60, 0x20, 0x20, 0x70, // 1
@@ -36,7 +40,33 @@ constexpr std::array<uint8_t, FONT_ELEMENT_SIZE> FONTSET {
 	0xF0, 0x80, 0xF0, 0x80, 0x80  // F
 };
 
+using MemoryPage = std::array<uint8_t, MEMORY_PAGE_SIZE>;
+using DisplayRow = std::array<uint32_t, DISPLAY_WIDTH>;
+
+// Snapshot of the machine for state-space search (keypad, RNG, trace and debugger are not part of it).
+// The first fault is saved and restored with the state, so a fault in one branch does not leak into others;
+// loading a state clears the last-cycle fault.
+// Memory pages and display rows are shared copy-on-write between snapshots, so saving and restoring
+// only copy what was written in between instead of the whole 12 KB.
+struct Chip8State {
+	std::array<std::shared_ptr<const MemoryPage>, MEMORY_PAGES> memory {};
+	std::array<std::shared_ptr<const DisplayRow>, DISPLAY_HEIGHT> graphics {};
+	std::array<uint8_t, REGISTERS> registers {};
+	uint16_t RI {};
+	uint16_t PC {};
+	std::array<uint16_t, STACK_DEPTH> stack {};
+	uint16_t SP {};
+	uint8_t delayTimer {};
+	uint8_t soundTimer {};
+	Fault fault {};
+	uint64_t hash {};
+};
+
+class Debugger;
+
 class Chip8 {
+	friend class Debugger;
+
   public:
 	Chip8();
 
@@ -44,8 +74,22 @@ class Chip8 {
 	void emulateCycle();
 	void fromOpcodeToFunction();
 
+	// Record every executed instruction, the ring is dumped to dumpPath on the first fault
+	void enableTrace(std::string_view dumpPath, size_t capacity = 1024);
+
 	[[nodiscard]] const std::array<uint32_t, DISPLAY_WIDTH * DISPLAY_HEIGHT>& getGraphics() const;
 	[[nodiscard]] const std::array<uint8_t, CHAR>& getKeypad() const;
+	[[nodiscard]] Fault getFault() const;
+	[[nodiscard]] Fault getLastFault() const; // fault raised by the last emulateCycle(), NONE if it ran cleanly
+
+	// Zobrist hash of memory, registers, PC, I, live stack slots, timers and display, kept up to date on every write
+	[[nodiscard]] uint64_t getHash() const;
+	// Hash recomputed from scratch, equal to getHash() unless a write bypassed the setters
+	[[nodiscard]] uint64_t computeHash() const;
+
+	// Clone support: saveState() costs one page copy per page written since the previous call
+	[[nodiscard]] Chip8State saveState();
+	void loadState(const Chip8State& state);
 
   private:
 	// Memory
@@ -77,6 +121,36 @@ class Chip8 {
 	// Audio
 	std::unique_ptr<Mix_Chunk, void (*)(Mix_Chunk *)> m_chunk;
 
+	// Trace
+	std::unique_ptr<Trace> m_trace; // nullptr when tracing is disabled
+	Fault m_fault {}; // first fault raised, only this one dumps the trace
+	Fault m_lastFault {}; // fault raised by the current/last instruction, the faulting instruction is skipped
+
+	void raiseFault(Fault fault);
+	void reportFault(uint16_t pc);
+	[[nodiscard]] bool inMemory(uint16_t address, uint16_t size);
+
+	// Debug
+	Debugger* m_watcher {}; // set by Debugger only while a watchpoint is armed
+
+	// State hash and copy-on-write pages shared with the last saved state
+	uint64_t m_hash {};
+	std::array<std::shared_ptr<const MemoryPage>, MEMORY_PAGES> m_memoryPages {};
+	std::array<std::shared_ptr<const DisplayRow>, DISPLAY_HEIGHT> m_graphicsRows {};
+	uint16_t m_dirtyPages {0xFFFF}; // pages of m_memory written since they were last shared, one bit per page
+	uint32_t m_dirtyRows {0xFFFFFFFF}; // same for the rows of m_graphics
+
+	// Every write to hashed state goes through these
+	void setRegister(uint8_t reg, uint8_t value);
+	void writeMemory(uint16_t address, uint8_t value);
+	void setPC(uint16_t address);
+	void setIndex(uint16_t address);
+	void pushStack(uint16_t address);
+	void popStack();
+	void setDelayTimer(uint8_t value);
+	void setSoundTimer(uint8_t value);
+	void flipPixel(uint16_t pixel);
+
 	// OPCODE Implementations http://devernay.free.fr/hacks/chip8/C8TECH10.HTM
 	void OPCODE_00E0(); // CLS
 	void OPCODE_00EE(); // RET
@@ -0,0 +1,353 @@
+#include <climits>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "Debugger.hpp"
+
+Debugger::Debugger(Chip8& chip) : m_chip {chip} {}
+
+Debugger::~Debugger() {
+	if(m_chip.m_watcher == this) m_chip.m_watcher = nullptr;
+}
+
+void Debugger::addBreakpoint(uint16_t address) {
+	if(address < MEMORY_SIZE) m_breakpoints.set(address);
+}
+
+void Debugger::removeBreakpoint(uint16_t address) {
+	if(address < MEMORY_SIZE) m_breakpoints.reset(address);
+}
+
+void Debugger::addRegisterBreakpoint(RegisterCondition condition) {
+	if(condition.reg >= REGISTERS) return;
+	m_conditions.push_back(condition);
+	m_conditionsHeld.push_back(holds(condition));
+}
+
+void Debugger::clearRegisterBreakpoints() {
+	m_conditions.clear();
+	m_conditionsHeld.clear();
+}
+
+void Debugger::addWatchpoint(uint16_t begin, uint16_t end, Access access) {
+	for(uint16_t address = begin; address <= end && address < MEMORY_SIZE; ++address){
+		if(static_cast<uint8_t>(access) & static_cast<uint8_t>(Access::READ)) m_readWatchpoints.set(address);
+		if(static_cast<uint8_t>(access) & static_cast<uint8_t>(Access::WRITE)) m_writeWatchpoints.set(address);
+	}
+	updateWatcher();
+}
+
+void Debugger::removeWatchpoint(uint16_t begin, uint16_t end, Access access) {
+	for(uint16_t address = begin; address <= end && address < MEMORY_SIZE; ++address){
+		if(static_cast<uint8_t>(access) & static_cast<uint8_t>(Access::READ)) m_readWatchpoints.reset(address);
+		if(static_cast<uint8_t>(access) & static_cast<uint8_t>(Access::WRITE)) m_writeWatchpoints.reset(address);
+	}
+	updateWatcher();
+}
+
+// Hook into Chip8 only while there is something to watch
+void Debugger::updateWatcher() {
+	const bool armed = m_readWatchpoints.any() || m_writeWatchpoints.any();
+	m_chip.m_watcher = armed ? this : nullptr;
+}
+
+void Debugger::onAccess(uint16_t address, uint16_t size, Access access) {
+	const auto& watchpoints = (access == Access::READ ? m_readWatchpoints : m_writeWatchpoints);
+	for(uint16_t i = 0; i < size; ++i){
+		if(watchpoints.test(address + i)){
+			m_watchHit = true;
+			m_watchAddress = address + i;
+			return;
+		}
+	}
+}
+
+bool Debugger::holds(const RegisterCondition& condition) const {
+	const uint8_t value = m_chip.m_registers[condition.reg];
+	switch (condition.cmp) {
+		case Compare::EQUAL: return value == condition.value;
+		case Compare::NOT_EQUAL: return value != condition.value;
+		case Compare::LESS: return value < condition.value;
+		case Compare::GREATER: return value > condition.value;
+	}
+	return false;
+}
+
+bool Debugger::conditionHit() {
+	bool hit = false;
+	for(size_t i = 0; i < m_conditions.size(); ++i){
+		const bool held = holds(m_conditions[i]);
+		if(held && !m_conditionsHeld[i]) hit = true;
+		m_conditionsHeld[i] = held;
+	}
+	return hit;
+}
+
+// Execute one instruction and report why execution should stop after it, if at all
+StopReason Debugger::execute() {
+	m_watchHit = false;
+	m_chip.emulateCycle();
+
+	// Conditions are updated on every instruction, even one that stops for another reason
+	const bool conditionChanged = !m_conditions.empty() && conditionHit();
+
+	if(m_chip.getLastFault() != Fault::NONE) return StopReason::FAULT;
+	if(m_watchHit) return StopReason::WATCHPOINT;
+	if(conditionChanged) return StopReason::REGISTER_BREAKPOINT;
+	return StopReason::NONE;
+}
+
+StopReason Debugger::step() {
+	m_stoppedAt = MEMORY_SIZE;
+	const StopReason reason = execute();
+	return reason == StopReason::NONE ? StopReason::STEP : reason;
+}
+
+StopReason Debugger::run(size_t maxCycles) {
+	for(size_t cycle = 0; cycle < maxCycles; ++cycle){
+		const uint16_t pc = m_chip.m_PC;
+		if(pc < MEMORY_SIZE && m_breakpoints.test(pc) && pc != m_stoppedAt){
+			m_stoppedAt = pc;
+			return StopReason::BREAKPOINT;
+		}
+		m_stoppedAt = MEMORY_SIZE;
+
+		const StopReason reason = execute();
+		if(reason != StopReason::NONE) return reason;
+	}
+	return StopReason::NONE;
+}
+
+uint16_t Debugger::getPC() const {
+	return m_chip.m_PC;
+}
+
+uint16_t Debugger::getIndex() const {
+	return m_chip.m_RI;
+}
+
+uint16_t Debugger::getSP() const {
+	return m_chip.m_SP;
+}
+
+const std::array<uint8_t, REGISTERS>& Debugger::getRegisters() const {
+	return m_chip.m_registers;
+}
+
+const std::array<uint16_t, STACK_DEPTH>& Debugger::getStack() const {
+	return m_chip.m_stack;
+}
+
+uint8_t Debugger::readMemory(uint16_t address) const {
+	return address < MEMORY_SIZE ? m_chip.m_memory[address] : 0;
+}
+
+uint16_t Debugger::getWatchAddress() const {
+	return m_watchAddress;
+}
+
+void Debugger::printState(std::ostream& out) const {
+	out << std::uppercase << std::hex << std::setfill('0')
+	    << "PC=" << std::setw(3) << getPC() << " I=" << std::setw(3) << getIndex()
+	    << " SP=" << std::dec << getSP() << std::hex
+	    << " DT=" << std::setw(2) << static_cast<int>(m_chip.m_delayTimer)
+	    << " ST=" << std::setw(2) << static_cast<int>(m_chip.m_soundTimer) << "\n";
+	for(uint8_t i = 0; i < REGISTERS; ++i){
+		out << "V" << static_cast<int>(i) << "=" << std::setw(2) << static_cast<int>(m_chip.m_registers[i])
+		    << (i % 8 == 7 ? "\n" : " ");
+	}
+	if(getSP() > 0){
+		out << "Stack:";
+		for(uint16_t i = 0; i < getSP() && i < STACK_DEPTH; ++i){
+			out << " " << std::setw(3) << m_chip.m_stack[i];
+		}
+		out << "\n";
+	}
+	out << std::dec << std::setfill(' ');
+}
+
+void Debugger::printMemory(std::ostream& out, uint16_t address, uint16_t length) const {
+	out << std::uppercase << std::hex << std::setfill('0');
+	for(uint16_t i = 0; i < length && address + i < MEMORY_SIZE; ++i){
+		if(i % 16 == 0) out << (i ? "\n" : "") << std::setw(3) << (address + i) << ":";
+		out << " " << std::setw(2) << static_cast<int>(m_chip.m_memory[address + i]);
+	}
+	out << std::dec << std::setfill(' ') << "\n";
+}
+
+void Debugger::printDisassembly(std::ostream& out, uint16_t address, uint16_t count) const {
+	for(uint16_t i = 0; i < count && address + 1 < MEMORY_SIZE; ++i, address += 2){
+		const uint16_t opcode = (m_chip.m_memory[address] << 8) | m_chip.m_memory[address + 1];
+		out << (address == getPC() ? "> " : "  ") << std::uppercase << std::hex << std::setfill('0')
+		    << std::setw(3) << address << "  " << std::setw(4) << opcode << "  "
+		    << std::dec << std::setfill(' ') << disassemble(opcode)
+		    << (m_breakpoints.test(address) ? "  [break]" : "") << "\n";
+	}
+}
+
+void Debugger::printStop(std::ostream& out, StopReason reason) const {
+	switch (reason) {
+		case StopReason::NONE: out << "Cycle limit reached"; break;
+		case StopReason::STEP: out << "Stepped"; break;
+		case StopReason::BREAKPOINT: out << "Breakpoint"; break;
+		case StopReason::REGISTER_BREAKPOINT: out << "Register breakpoint"; break;
+		case StopReason::WATCHPOINT:
+			out << "Watchpoint at 0x" << std::uppercase << std::hex << m_watchAddress << std::dec;
+			break;
+		case StopReason::FAULT: out << "Fault: " << faultName(m_chip.getLastFault()); break;
+	}
+	out << "\n";
+	printDisassembly(out, getPC(), 1);
+}
+
+namespace {
+	constexpr std::string_view HELP {
+		"h                     print this help\n"
+		"s [n]                 step n instructions, n is decimal (default 1)\n"
+		"c                     continue\n"
+		"b <addr>              add breakpoint\n"
+		"d <addr>              delete breakpoint\n"
+		"rb <Vx> <op> <byte>   break when Vx op byte, op is one of == != < >\n"
+		"rd                    delete all register breakpoints\n"
+		"w <begin> <end> [acc] watch memory for acc = r, w or rw accesses (default rw)\n"
+		"dw <begin> <end>      delete watchpoint\n"
+		"r                     print registers\n"
+		"x <addr> [len]        dump memory\n"
+		"l [addr] [n]          disassemble\n"
+		"q                     quit\n"
+	};
+
+	// The whole token must be a number in [0, max], std::stoul alone would accept "22G" or "1000A"
+	bool parseToken(const std::string& token, int base, unsigned long max, unsigned long& value) {
+		size_t pos {};
+		try {
+			value = std::stoul(token, &pos, base);
+		} catch (const std::exception&) {
+			return false;
+		}
+		return pos == token.size() && value <= max;
+	}
+
+	// Numbers are hexadecimal, with or without 0x, as everywhere else in CHIP-8 docs
+	bool parseNumber(std::istringstream& args, unsigned long max, unsigned long& value) {
+		std::string token;
+		if(!(args >> token)) return false;
+		if(token[0] == 'V' || token[0] == 'v') token.erase(0, 1);
+		return parseToken(token, 16, max, value);
+	}
+
+	// Same as parseNumber, but a missing number is not an error and leaves value untouched
+	bool parseOptionalNumber(std::istringstream& args, unsigned long max, unsigned long& value) {
+		std::string token;
+		if(!(args >> token)) return true;
+		return parseToken(token, 16, max, value);
+	}
+
+	// Counts are decimal, unlike addresses and values; a missing count is 1
+	bool parseCount(std::istringstream& args, unsigned long& count) {
+		std::string token;
+		count = 1;
+		if(!(args >> token)) return true;
+		return parseToken(token, 10, ULONG_MAX, count);
+	}
+
+	bool parseCompare(std::istringstream& args, Compare& cmp) {
+		std::string token;
+		if(!(args >> token)) return false;
+		if(token == "==") cmp = Compare::EQUAL;
+		else if(token == "!=") cmp = Compare::NOT_EQUAL;
+		else if(token == "<") cmp = Compare::LESS;
+		else if(token == ">") cmp = Compare::GREATER;
+		else return false;
+		return true;
+	}
+
+	bool parseAccess(std::istringstream& args, Access& access) {
+		std::string token;
+		if(!(args >> token) || token == "rw") access = Access::READ_WRITE;
+		else if(token == "r") access = Access::READ;
+		else if(token == "w") access = Access::WRITE;
+		else return false;
+		return true;
+	}
+}
+
+bool Debugger::repl(std::istream& in, std::ostream& out) {
+	std::string line;
+	out << "(chip8) " << std::flush;
+	while(std::getline(in, line)) {
+		std::istringstream args {line};
+		std::string command;
+		args >> command;
+
+		unsigned long first {}, second {};
+		if(command.empty()) {
+		} else if(command == "h") {
+			out << HELP;
+		} else if(command == "s") {
+			unsigned long count {};
+			if(parseCount(args, count)) {
+				StopReason reason = StopReason::STEP;
+				for(unsigned long i = 0; i < count && reason == StopReason::STEP; ++i) reason = step();
+				printStop(out, reason);
+			} else {
+				out << "Usage: s [n]\n";
+			}
+		} else if(command == "c") {
+			return true;
+		} else if(command == "q") {
+			return false;
+		} else if(command == "b" || command == "d") {
+			if(parseNumber(args, MEMORY_SIZE - 1, first)) {
+				if(command == "b") addBreakpoint(first);
+				else removeBreakpoint(first);
+			} else {
+				out << "Usage: " << command << " <addr>\n";
+			}
+		} else if(command == "rb") {
+			Compare cmp {};
+			if(parseNumber(args, REGISTERS - 1, first) && parseCompare(args, cmp) && parseNumber(args, 0xFF, second)) {
+				addRegisterBreakpoint({static_cast<uint8_t>(first), cmp, static_cast<uint8_t>(second)});
+			} else {
+				out << "Usage: rb <Vx> <op> <byte>\n";
+			}
+		} else if(command == "rd") {
+			clearRegisterBreakpoints();
+		} else if(command == "w") {
+			Access access {};
+			if(parseNumber(args, MEMORY_SIZE - 1, first) && parseNumber(args, MEMORY_SIZE - 1, second) && parseAccess(args, access)) {
+				addWatchpoint(first, second, access);
+			} else {
+				out << "Usage: w <begin> <end> [r|w|rw]\n";
+			}
+		} else if(command == "dw") {
+			if(parseNumber(args, MEMORY_SIZE - 1, first) && parseNumber(args, MEMORY_SIZE - 1, second)) {
+				removeWatchpoint(first, second, Access::READ_WRITE);
+			} else {
+				out << "Usage: dw <begin> <end>\n";
+			}
+		} else if(command == "r") {
+			printState(out);
+		} else if(command == "x") {
+			second = 16;
+			if(parseNumber(args, MEMORY_SIZE - 1, first) && parseOptionalNumber(args, MEMORY_SIZE, second)) {
+				printMemory(out, first, second);
+			} else {
+				out << "Usage: x <addr> [len]\n";
+			}
+		} else if(command == "l") {
+			first = getPC();
+			second = 8;
+			if(parseOptionalNumber(args, MEMORY_SIZE - 1, first) && parseOptionalNumber(args, MEMORY_SIZE / 2, second)) {
+				printDisassembly(out, first, second);
+			} else {
+				out << "Usage: l [addr] [n]\n";
+			}
+		} else {
+			out << HELP;
+		}
+		out << "(chip8) " << std::flush;
+	}
+	return false;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <iostream>
+#include <bitset>
+#include <vector>
+
+#include "Chip8.hpp"
+
+enum class Access : uint8_t {
+	READ = 1,
+	WRITE = 2,
+	READ_WRITE = READ | WRITE
+};
+
+enum class Compare : uint8_t {
+	EQUAL,
+	NOT_EQUAL,
+	LESS,
+	GREATER
+};
+
+enum class StopReason : uint8_t {
+	NONE, // cycle budget exhausted
+	STEP,
+	BREAKPOINT,
+	REGISTER_BREAKPOINT,
+	WATCHPOINT,
+	FAULT
+};
+
+// Vx <cmp> value, checked after every instruction while at least one is armed.
+// It stops execution when the condition becomes true, not while it stays true.
+struct RegisterCondition {
+	uint8_t reg {};
+	Compare cmp {};
+	uint8_t value {};
+};
+
+// Stepping and inspection layer over Chip8.
+// Breakpoints and watchpoints live in bitmaps over the address space: run() pays one bit test per
+// instruction, and Chip8 only calls back into the debugger while a watchpoint is armed.
+class Debugger {
+  public:
+	explicit Debugger(Chip8& chip);
+	~Debugger();
+
+	Debugger(const Debugger&) = delete;
+	Debugger& operator=(const Debugger&) = delete;
+
+	void addBreakpoint(uint16_t address);
+	void removeBreakpoint(uint16_t address);
+	void addRegisterBreakpoint(RegisterCondition condition);
+	void clearRegisterBreakpoints();
+	// Watch [begin, end] for the given access, as done by Fx33, Fx55, Fx65 and Dxyn
+	void addWatchpoint(uint16_t begin, uint16_t end, Access access);
+	void removeWatchpoint(uint16_t begin, uint16_t end, Access access);
+
+	StopReason step();
+	StopReason run(size_t maxCycles);
+
+	[[nodiscard]] uint16_t getPC() const;
+	[[nodiscard]] uint16_t getIndex() const;
+	[[nodiscard]] uint16_t getSP() const;
+	[[nodiscard]] const std::array<uint8_t, REGISTERS>& getRegisters() const;
+	[[nodiscard]] const std::array<uint16_t, STACK_DEPTH>& getStack() const;
+	[[nodiscard]] uint8_t readMemory(uint16_t address) const;
+	[[nodiscard]] uint16_t getWatchAddress() const; // address that triggered the last WATCHPOINT stop
+
+	void printState(std::ostream& out) const;
+	void printMemory(std::ostream& out, uint16_t address, uint16_t length) const;
+	void printDisassembly(std::ostream& out, uint16_t address, uint16_t count) const;
+	void printStop(std::ostream& out, StopReason reason) const;
+
+	// Read commands until "continue" (returns true) or "quit"/end of input (returns false)
+	bool repl(std::istream& in, std::ostream& out);
+
+	// Called by Chip8 on memory accesses while a watchpoint is armed
+	void onAccess(uint16_t address, uint16_t size, Access access);
+
+  private:
+	Chip8& m_chip;
+
+	std::bitset<MEMORY_SIZE> m_breakpoints {};
+	std::bitset<MEMORY_SIZE> m_readWatchpoints {};
+	std::bitset<MEMORY_SIZE> m_writeWatchpoints {};
+	std::vector<RegisterCondition> m_conditions {};
+	std::vector<bool> m_conditionsHeld {}; // last result of each condition
+
+	bool m_watchHit {};
+	uint16_t m_watchAddress {};
+	uint16_t m_stoppedAt {MEMORY_SIZE}; // breakpoint we are stopped on, skipped once when resuming
+
+	StopReason execute();
+	void updateWatcher();
+	[[nodiscard]] bool holds(const RegisterCondition& condition) const;
+	[[nodiscard]] bool conditionHit();
+};
@@ -0,0 +1,27 @@
+#include <iostream>
+
+#include "Chip8.hpp"
+#include "Debugger.hpp"
+
+// Cycles executed by "c" before handing control back, headless ROMs never see a key press
+constexpr size_t CYCLE_LIMIT {1'000'000};
+
+// Headless debugger, no window and no audio
+// Usage: CHIP_8_DEBUG <rom>
+int main(int argc, char* argv[]) {
+	if(argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <rom>" << std::endl;
+		return 1;
+	}
+
+	Chip8 chip {};
+	chip.loadGame(argv[1]);
+	Debugger debugger {chip};
+
+	debugger.printDisassembly(std::cout, debugger.getPC(), 1);
+	while(debugger.repl(std::cin, std::cout)) {
+		debugger.printStop(std::cout, debugger.run(CYCLE_LIMIT));
+	}
+
+	return 0;
+}
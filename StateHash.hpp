@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Parts of the machine state covered by the Zobrist hash
+enum class HashComponent : uint8_t {
+	MEMORY,
+	REGISTER,
+	PC,
+	INDEX,
+	STACK,
+	SP,
+	DELAY_TIMER,
+	SOUND_TIMER,
+	PIXEL
+};
+
+// Zobrist key for "slot of component holds value".
+// Keys are derived with splitmix64 instead of being tabulated: a table for 4096 memory cells
+// x 256 values alone would take 8 MB and miss the cache on every write.
+constexpr uint64_t zobrist(HashComponent component, uint32_t slot, uint32_t value) {
+	uint64_t key = (static_cast<uint64_t>(component) << 40) | (static_cast<uint64_t>(slot) << 16) | value;
+	key += 0x9E3779B97F4A7C15;
+	key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9;
+	key = (key ^ (key >> 27)) * 0x94D049BB133111EB;
+	return key ^ (key >> 31);
+}
+
+// Replace the contribution of a slot in hash, in O(1)
+constexpr uint64_t rehashSlot(uint64_t hash, HashComponent component, uint32_t slot, uint32_t oldValue, uint32_t newValue) {
+	return hash ^ zobrist(component, slot, oldValue) ^ zobrist(component, slot, newValue);
+}
@@ -0,0 +1,130 @@
+#include <array>
+#include <bit>
+#include <cstdio>
+#include <fstream>
+
+#include "Trace.hpp"
+
+Trace::Trace(std::string_view dumpPath, size_t capacity) : m_dumpPath {dumpPath}
+                                                          , m_entries(std::bit_ceil(capacity == 0 ? 1 : capacity))
+                                                          , m_mask {m_entries.size() - 1}
+{}
+
+std::vector<TraceEntry> Trace::entries() const {
+	size_t count = m_head < m_entries.size() ? m_head : m_entries.size();
+	std::vector<TraceEntry> ordered {};
+	ordered.reserve(count);
+	for(size_t i = m_head - count; i < m_head; ++i){
+		ordered.push_back(m_entries[i & m_mask]);
+	}
+	return ordered;
+}
+
+bool Trace::dump(Fault fault) const {
+	std::ofstream file {m_dumpPath, std::ios::out | std::ios::binary | std::ios::trunc};
+	if(!file.is_open()) return false;
+
+	const auto ordered = entries();
+	const auto count = static_cast<uint32_t>(ordered.size());
+
+	file.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+	file.put(static_cast<char>(TRACE_VERSION));
+	file.put(static_cast<char>(fault));
+	for(int shift = 0; shift < 32; shift += 8){
+		file.put(static_cast<char>((count >> shift) & 0xFF));
+	}
+
+	for(const auto& entry : ordered){
+		const std::array<uint8_t, TRACE_ENTRY_SIZE> bytes {
+			static_cast<uint8_t>(entry.pc & 0xFF), static_cast<uint8_t>(entry.pc >> 8),
+			static_cast<uint8_t>(entry.opcode & 0xFF), static_cast<uint8_t>(entry.opcode >> 8),
+			static_cast<uint8_t>(entry.index & 0xFF), static_cast<uint8_t>(entry.index >> 8),
+			entry.value, entry.sp
+		};
+		file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	}
+
+	return file.good();
+}
+
+std::string_view faultName(Fault fault) {
+	switch (fault) {
+		case Fault::NONE: return "none";
+		case Fault::INVALID_OPCODE: return "invalid opcode";
+		case Fault::STACK_OVERFLOW: return "stack overflow";
+		case Fault::STACK_UNDERFLOW: return "stack underflow";
+		case Fault::MEMORY_OUT_OF_RANGE: return "memory out of range";
+	}
+	return "unknown";
+}
+
+// Mnemonics follow http://devernay.free.fr/hacks/chip8/C8TECH10.HTM
+std::string disassemble(uint16_t opcode) {
+	const unsigned x = (opcode & 0x0F00) >> 8;
+	const unsigned y = (opcode & 0x00F0) >> 4;
+	const unsigned n = opcode & 0x000F;
+	const unsigned kk = opcode & 0x00FF;
+	const unsigned nnn = opcode & 0x0FFF;
+
+	char text[32] {};
+	switch ((opcode & 0xF000) >> 12) {
+		case 0x0:
+			if(n == 0x0) return "CLS";
+			if(n == 0xE) return "RET";
+			break;
+		case 0x1: std::snprintf(text, sizeof(text), "JP 0x%03X", nnn); return text;
+		case 0x2: std::snprintf(text, sizeof(text), "CALL 0x%03X", nnn); return text;
+		case 0x3: std::snprintf(text, sizeof(text), "SE V%X, 0x%02X", x, kk); return text;
+		case 0x4: std::snprintf(text, sizeof(text), "SNE V%X, 0x%02X", x, kk); return text;
+		case 0x5: if(n == 0) { std::snprintf(text, sizeof(text), "SE V%X, V%X", x, y); return text; } break;
+		case 0x6: std::snprintf(text, sizeof(text), "LD V%X, 0x%02X", x, kk); return text;
+		case 0x7: std::snprintf(text, sizeof(text), "ADD V%X, 0x%02X", x, kk); return text;
+		case 0x8: {
+			constexpr std::array<const char*, 16> ALU {"LD", "OR", "AND", "XOR", "ADD", "SUB", "SHR", "SUBN",
+			                                           nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "SHL", nullptr};
+			if(ALU[n]) { std::snprintf(text, sizeof(text), "%s V%X, V%X", ALU[n], x, y); return text; }
+		} break;
+		case 0x9: if(n == 0) { std::snprintf(text, sizeof(text), "SNE V%X, V%X", x, y); return text; } break;
+		case 0xA: std::snprintf(text, sizeof(text), "LD I, 0x%03X", nnn); return text;
+		case 0xB: std::snprintf(text, sizeof(text), "JP V0, 0x%03X", nnn); return text;
+		case 0xC: std::snprintf(text, sizeof(text), "RND V%X, 0x%02X", x, kk); return text;
+		case 0xD: std::snprintf(text, sizeof(text), "DRW V%X, V%X, %u", x, y, n); return text;
+		case 0xE:
+		case 0xF:
+			switch (kk) {
+				case 0x9E: std::snprintf(text, sizeof(text), "SKP V%X", x); return text;
+				case 0xA1: std::snprintf(text, sizeof(text), "SKNP V%X", x); return text;
+				case 0x07: std::snprintf(text, sizeof(text), "LD V%X, DT", x); return text;
+				case 0x0A: std::snprintf(text, sizeof(text), "LD V%X, K", x); return text;
+				case 0x15: std::snprintf(text, sizeof(text), "LD DT, V%X", x); return text;
+				case 0x18: std::snprintf(text, sizeof(text), "LD ST, V%X", x); return text;
+				case 0x1E: std::snprintf(text, sizeof(text), "ADD I, V%X", x); return text;
+				case 0x29: std::snprintf(text, sizeof(text), "LD F, V%X", x); return text;
+				case 0x33: std::snprintf(text, sizeof(text), "LD B, V%X", x); return text;
+				case 0x55: std::snprintf(text, sizeof(text), "LD [I], V%X", x); return text;
+				case 0x65: std::snprintf(text, sizeof(text), "LD V%X, [I]", x); return text;
+			}
+			break;
+	}
+	std::snprintf(text, sizeof(text), "DW 0x%04X", opcode);
+	return text;
+}
+
+bool writesVx(uint16_t opcode) {
+	switch ((opcode & 0xF000) >> 12) {
+		case 0x6:
+		case 0x7:
+		case 0xC: return true;
+		case 0x8: return (opcode & 0x000F) <= 0x7 || (opcode & 0x000F) == 0xE;
+		case 0xF: return (opcode & 0x00FF) == 0x07 || (opcode & 0x00FF) == 0x0A || (opcode & 0x00FF) == 0x65;
+		default: return false;
+	}
+}
+
+bool writesIndex(uint16_t opcode) {
+	switch ((opcode & 0xF000) >> 12) {
+		case 0xA: return true;
+		case 0xF: return (opcode & 0x00FF) == 0x1E || (opcode & 0x00FF) == 0x29;
+		default: return false;
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One executed instruction: 8 bytes, so a 1024 entry ring fits in 8 KB
+struct TraceEntry {
+	uint16_t pc {}; // address the opcode was fetched from
+	uint16_t opcode {};
+	uint16_t index {}; // I after execution
+	uint8_t value {}; // Vx after execution (x = second nibble of the opcode)
+	uint8_t sp {}; // stack pointer after execution
+};
+
+enum class Fault : uint8_t {
+	NONE,
+	INVALID_OPCODE,
+	STACK_OVERFLOW,
+	STACK_UNDERFLOW,
+	MEMORY_OUT_OF_RANGE
+};
+
+// Binary dump layout (little endian):
+//   "C8TR" | version (1 byte) | fault (1 byte) | entry count (4 bytes) | entries, oldest first
+constexpr char TRACE_MAGIC[4] {'C', '8', 'T', 'R'};
+constexpr uint8_t TRACE_VERSION {1};
+constexpr uint8_t TRACE_ENTRY_SIZE {8};
+
+class Trace {
+  public:
+	// capacity is rounded up to a power of two so that wrapping is a single AND
+	explicit Trace(std::string_view dumpPath, size_t capacity = 1024);
+
+	void record(uint16_t pc, uint16_t opcode, uint16_t index, uint8_t value, uint8_t sp) {
+		m_entries[m_head & m_mask] = {pc, opcode, index, value, sp};
+		m_head++;
+	}
+
+	// Write the buffered entries to the dump path, oldest first
+	bool dump(Fault fault) const;
+
+	[[nodiscard]] std::vector<TraceEntry> entries() const;
+
+  private:
+	std::string m_dumpPath;
+	std::vector<TraceEntry> m_entries;
+	size_t m_mask {};
+	size_t m_head {}; // total entries recorded, never wraps in practice
+};
+
+[[nodiscard]] std::string_view faultName(Fault fault);
+[[nodiscard]] std::string disassemble(uint16_t opcode);
+
+// Returns true if the opcode writes Vx / I, used to print only the state an instruction changed
+[[nodiscard]] bool writesVx(uint16_t opcode);
+[[nodiscard]] bool writesIndex(uint16_t opcode);
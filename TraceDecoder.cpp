@@ -0,0 +1,71 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <array>
+#include <algorithm>
+
+#include "Trace.hpp"
+
+// Offline decoder for the binary trace dumped by Chip8 on a fault
+// Usage: CHIP_8_TRACE <trace file>
+int main(int argc, char* argv[]) {
+	if(argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <trace file>" << std::endl;
+		return 1;
+	}
+
+	std::ifstream file {argv[1], std::ios::in | std::ios::binary};
+	if(!file.is_open()) {
+		std::cerr << "Trace could not be opened" << std::endl;
+		return 1;
+	}
+
+	std::array<uint8_t, sizeof(TRACE_MAGIC) + 6> header {};
+	file.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+	if(!file || !std::equal(std::begin(TRACE_MAGIC), std::end(TRACE_MAGIC), header.begin())) {
+		std::cerr << "Not a CHIP-8 trace" << std::endl;
+		return 1;
+	}
+	if(header[4] != TRACE_VERSION) {
+		std::cerr << "Unsupported trace version " << static_cast<int>(header[4]) << std::endl;
+		return 1;
+	}
+
+	const auto fault = static_cast<Fault>(header[5]);
+	const uint32_t count = header[6] | (header[7] << 8) | (header[8] << 16) | (static_cast<uint32_t>(header[9]) << 24);
+
+	std::cout << "Fault: " << faultName(fault) << "\n"
+	          << "Entries: " << count << "\n\n"
+	          << "PC     OPCODE  INSTRUCTION        SP  CHANGED\n";
+
+	std::array<uint8_t, TRACE_ENTRY_SIZE> bytes {};
+	for(uint32_t i = 0; i < count; ++i) {
+		if(!file.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+			std::cerr << "Trace truncated after " << i << " entries" << std::endl;
+			return 1;
+		}
+
+		const TraceEntry entry {
+			static_cast<uint16_t>(bytes[0] | (bytes[1] << 8)),
+			static_cast<uint16_t>(bytes[2] | (bytes[3] << 8)),
+			static_cast<uint16_t>(bytes[4] | (bytes[5] << 8)),
+			bytes[6], bytes[7]
+		};
+
+		std::cout << std::uppercase << std::hex << std::setfill('0')
+		          << "0x" << std::setw(3) << entry.pc << "  "
+		          << std::setw(4) << entry.opcode << "    "
+		          << std::setfill(' ') << std::left << std::setw(17) << disassemble(entry.opcode) << std::right << "  "
+		          << std::dec << std::setw(2) << static_cast<int>(entry.sp) << "  " << std::hex << std::setfill('0');
+
+		if(writesVx(entry.opcode)) {
+			std::cout << "V" << ((entry.opcode & 0x0F00) >> 8) << "=0x" << std::setw(2) << static_cast<int>(entry.value);
+		}
+		if(writesIndex(entry.opcode)) {
+			std::cout << "I=0x" << std::setw(3) << entry.index;
+		}
+		std::cout << std::dec << std::setfill(' ') << "\n";
+	}
+
+	return 0;
+}
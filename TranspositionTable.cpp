@@ -0,0 +1,40 @@
+#include <algorithm>
+#include <bit>
+
+#include "TranspositionTable.hpp"
+
+TranspositionTable::TranspositionTable(size_t capacity) : m_slots(std::bit_ceil(capacity == 0 ? 1 : capacity))
+                                                        , m_mask {m_slots.size() - 1}
+{}
+
+// 0 is the empty marker, the (1 in 2^64) state hashing to 0 is stored as 1
+uint64_t TranspositionTable::key(uint64_t hash) {
+	return hash == 0 ? 1 : hash;
+}
+
+bool TranspositionTable::insert(uint64_t hash) {
+	const uint64_t stored = key(hash);
+	uint64_t& slot = m_slots[stored & m_mask];
+	if(slot == stored) return false;
+	if(slot == 0) m_size++;
+	slot = stored;
+	return true;
+}
+
+bool TranspositionTable::contains(uint64_t hash) const {
+	const uint64_t stored = key(hash);
+	return m_slots[stored & m_mask] == stored;
+}
+
+void TranspositionTable::clear() {
+	std::fill(m_slots.begin(), m_slots.end(), 0);
+	m_size = 0;
+}
+
+size_t TranspositionTable::size() const {
+	return m_size;
+}
+
+size_t TranspositionTable::capacity() const {
+	return m_slots.size();
+}
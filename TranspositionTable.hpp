@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Bounded set of state hashes for deduplicating explored states.
+// Direct mapped: an insert that lands on an occupied slot replaces the older hash, so memory
+// stays fixed and a forgotten state is at worst explored twice.
+class TranspositionTable {
+  public:
+	// capacity is rounded up to a power of two
+	explicit TranspositionTable(size_t capacity);
+
+	// Returns true if hash was not in the table, i.e. the state has not been seen yet
+	bool insert(uint64_t hash);
+	[[nodiscard]] bool contains(uint64_t hash) const;
+	void clear();
+
+	[[nodiscard]] size_t size() const; // occupied slots
+	[[nodiscard]] size_t capacity() const;
+
+  private:
+	std::vector<uint64_t> m_slots; // 0 marks an empty slot
+	size_t m_mask {};
+	size_t m_size {};
+
+	[[nodiscard]] static uint64_t key(uint64_t hash);
+};
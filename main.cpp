@@ -3,8 +3,10 @@
 #include <vector>
 #include <utility>
 #include <filesystem>
+#include <memory>
 
 #include "Chip8.hpp"
+#include "Debugger.hpp"
 #include "Platform.hpp"
 
 void loadAudio() {
@@ -40,13 +42,17 @@ std::string menu() {
 	return games[choice - 1].first;
 }
 
-int main() {
+// Usage: CHIP_8 [--debug]
+// With --debug the debugger prompt opens on stdin before the first cycle and on every stop
+int main(int argc, char* argv[]) {
+	const bool debug = argc > 1 && std::string_view {argv[1]} == "--debug";
 	loadAudio();
 	Chip8 chip {};
 	int videoScale = 10;
 	int delay = 1;
 	const std::string& path = menu();
 	chip.loadGame(path);
+	chip.enableTrace("trace.bin");
 
 	Platform platform {"Chip-8 Emulator", DISPLAY_WIDTH * videoScale, DISPLAY_HEIGHT * videoScale, DISPLAY_WIDTH, DISPLAY_HEIGHT};
 
@@ -56,13 +62,24 @@ int main() {
 	auto prev = std::chrono::high_resolution_clock::now();
 	bool end = false;
 
+	std::unique_ptr<Debugger> debugger {};
+	if(debug) {
+		debugger = std::make_unique<Debugger>(chip);
+		end = !debugger->repl(std::cin, std::cout);
+	}
+
 	while(!end) {
 		end = platform.processInput(keyboards);
 		auto now = std::chrono::high_resolution_clock::now();
 		float diff = std::chrono::duration<float, std::chrono::milliseconds::period>(now - prev).count();
 		if (diff > static_cast<float>(delay)) {
 			prev = now;
-			chip.emulateCycle();
+			if(!debugger) {
+				chip.emulateCycle();
+			} else if(StopReason reason = debugger->run(1); reason != StopReason::NONE) {
+				debugger->printStop(std::cout, reason);
+				end = !debugger->repl(std::cin, std::cout);
+			}
 			platform.update(&graphics[0], 256);
 		}
 